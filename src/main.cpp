@@ -1,8 +1,15 @@
+#include <cmath>
 #include <filesystem>
 #include <fstream>
 #include <iostream>
+#include <algorithm>
+#include <memory>
 #include <vector>
 #include "perceptron/perceptron.hpp"
+#include "perceptron/sparse/sparse.hpp"
+#include "perceptron/pipeline/pipeline.hpp"
+#include "perceptron/online/online.hpp"
+#include "perceptron/compiler/compiler.hpp"
 
 constexpr size_t input_size = 49;
 constexpr size_t output_size = 3;
@@ -17,10 +24,33 @@ constexpr double learning_barrier = 0.001;
 constexpr double max_barrier = 3;
 
 constexpr size_t learning_epoch_amount = 130;
+constexpr uint64_t initialization_seed = 42;
+constexpr Initialization initialization = Initialization::Uniform;
+constexpr size_t fine_tuning_epoch_amount = 10;
+
+constexpr double pruning_sparsities[] = {0.5, 0.8, 0.9};
+constexpr bool per_layer_pruning = false;
+
+constexpr size_t pipeline_stage_count = 2;
+constexpr size_t pipeline_batch_size = 4;
+constexpr size_t pipeline_stream_repeat = 100;
+
+constexpr size_t online_epoch_amount = 20;
+constexpr size_t online_publish_interval = 60;
+constexpr size_t online_reader_count = 2;
+constexpr std::chrono::milliseconds online_idle_time(200);
+
+constexpr bool profiling_enabled = false;
+
+constexpr size_t compiled_model_repeat = 1000;
 
 constexpr std::string_view training_directory = "src/data/train";
 constexpr std::string_view validation_directory = "src/data/validate";
 std::string model_file = "src/data/model/model.txt";
+std::string profile_file = "build/profile.csv";
+std::string compiled_model_directory = "build";
+
+Profiler *profiler = nullptr;
 
 struct bitImage
 {
@@ -39,6 +69,9 @@ struct model
 
 bitImage readImage(auto &path)
 {
+    if (profiler)
+        profiler->begin(ProfilePhase::DataLoading);
+
     bitImage image;
 
     image.type.resize(output_size);
@@ -50,6 +83,9 @@ bitImage readImage(auto &path)
         file >> image.data[i];
     file.close();
 
+    if (profiler)
+        profiler->end(ProfilePhase::DataLoading);
+
     return image;
 }
 
@@ -127,16 +163,27 @@ void printVector(std::vector<double> vector)
     std::cout << std::endl;
 }
 
-void train(Perceptron &perceptron, bool verbose = false)
+double get_error(std::vector<double> &expected_output, std::vector<double> &output)
+{
+    double error = 0;
+    for (size_t output_index = 0; output_index < expected_output.size(); output_index++)
+    {
+        error += fabs(expected_output[output_index] - output[output_index]);
+    }
+
+    return error / 2;
+}
+
+void train(Perceptron &perceptron, size_t epoch_amount = learning_epoch_amount, bool verbose = false)
 {
     double old_mean_error = 10;
     double count_barrier = 0;
-    double mean_error;
+    double mean_error = 0;
 
     size_t epoch;
     clock_t start = clock();
 
-    for (epoch = 1; epoch <= learning_epoch_amount; epoch++)
+    for (epoch = 1; epoch <= epoch_amount; epoch++)
     {
         mean_error = 0;
         int file_count = 0;
@@ -233,7 +280,347 @@ void validate(Perceptron &perceptron, model &perceptron_model, bool verbose = fa
     std::cout << "Mean error on validation is " << mean_error << std::endl;
 }
 
+void validate(SparsePerceptron &perceptron, bool verbose = false)
+{
+    std::vector<std::vector<double>> batch;
+    std::vector<std::vector<double>> expected_outputs;
+
+    for (auto &validation_path : std::filesystem::directory_iterator(validation_directory))
+    {
+        bitImage image = readImage(validation_path.path());
+        batch.push_back(image.data);
+        expected_outputs.push_back(image.type);
+    }
+
+    clock_t start = clock();
+    std::vector<std::vector<double>> outputs = perceptron.run(batch);
+    double mean_time = (double)(clock() - start)/CLOCKS_PER_SEC / batch.size();
+
+    double mean_error = 0;
+    int success_count = 0;
+
+    for (size_t sample_index = 0; sample_index < batch.size(); sample_index++)
+    {
+        double error = get_error(expected_outputs[sample_index], outputs[sample_index]);
+
+        if (error <= max_validation_error)
+            success_count++;
+
+        mean_error += error;
+
+        if (verbose)
+        {
+            printSeparator();
+            std::cout << "Expected output: ";
+            printVector(expected_outputs[sample_index]);
+            std::cout << std::endl;
+            std::cout << "Actual output: ";
+            printVector(outputs[sample_index]);
+            std::cout << std::endl;
+            std::cout << "Error: " << error << std::endl;
+            printSeparator();
+        }
+    }
+
+    mean_error /= batch.size();
+    double success_rate = (double)(success_count) / (double)(batch.size()) * 100;
+
+    std::cout << "Sparse validation at " << perceptron.get_sparsity() * 100 << "% sparsity ended with " << success_rate << "% of correct results | Mean output time: " << std::fixed << std::setprecision(7) << mean_time << std::endl;
+    std::cout << "Mean error on validation is " << mean_error << " | Model size: " << perceptron.get_memory_size() << " bytes (dense " << perceptron.get_dense_memory_size() << " bytes)" << std::endl;
+}
+
+void prune(model &perceptron_model, double sparsity)
+{
+    Perceptron pruning_perceptron(
+        perceptron_model.input_size,
+        perceptron_model.output_size,
+        perceptron_model.layer_count,
+        perceptron_model.hidden_layer_size,
+        max_learning_error,
+        min_learning_factor,
+        max_learning_factor
+    );
+
+    pruning_perceptron.set_input(std::vector<double>(perceptron_model.input_size));
+    pruning_perceptron.set_expected_output(std::vector<double>(perceptron_model.output_size));
+    pruning_perceptron.set_weights(perceptron_model.weights);
+
+    pruning_perceptron.prune(sparsity, per_layer_pruning);
+
+    if (fine_tuning_epoch_amount > 0)
+        train(pruning_perceptron, fine_tuning_epoch_amount);
+
+    std::vector<std::vector<double>> weights = pruning_perceptron.get_weights();
+
+    SparsePerceptron sparse_perceptron(
+        perceptron_model.input_size,
+        perceptron_model.output_size,
+        perceptron_model.layer_count,
+        perceptron_model.hidden_layer_size,
+        weights
+    );
+
+    validate(sparse_perceptron);
+}
+
+void stream(PipelinedPerceptron &perceptron)
+{
+    std::vector<ActivationBatch> batches;
+    std::vector<ActivationBatch> expected_outputs;
+
+    for (size_t repeat = 0; repeat < pipeline_stream_repeat; repeat++)
+    {
+        for (auto &validation_path : std::filesystem::directory_iterator(validation_directory))
+        {
+            bitImage image = readImage(validation_path.path());
+
+            if (batches.empty() || batches.back().size() == pipeline_batch_size)
+            {
+                batches.emplace_back();
+                expected_outputs.emplace_back();
+            }
+
+            batches.back().push_back(image.data);
+            expected_outputs.back().push_back(image.type);
+        }
+    }
+
+    size_t sample_count = 0;
+    size_t success_count = 0;
+    size_t pushed_count = 0;
+    size_t popped_count = 0;
+    ActivationBatch outputs;
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    perceptron.start();
+
+    // Batches leave the pipeline in the order they entered it.
+    while (popped_count < batches.size())
+    {
+        if (pushed_count < batches.size() && perceptron.push(std::move(batches[pushed_count])))
+            pushed_count++;
+
+        if (!perceptron.pop(outputs))
+        {
+            std::this_thread::yield();
+            continue;
+        }
+
+        for (size_t sample_index = 0; sample_index < outputs.size(); sample_index++)
+        {
+            if (get_error(expected_outputs[popped_count][sample_index], outputs[sample_index]) <= max_validation_error)
+                success_count++;
+            sample_count++;
+        }
+        popped_count++;
+    }
+
+    perceptron.stop();
+    double elapsed_time = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    double success_rate = (double)(success_count) / (double)(sample_count) * 100;
+
+    std::cout << "Pipelined stream of " << sample_count << " samples ended with " << success_rate << "% of correct results | Throughput: " << sample_count / elapsed_time << " samples/s" << std::endl;
+
+    std::vector<size_t> layer_counts = perceptron.get_stage_layer_counts();
+    std::vector<double> utilization = perceptron.get_stage_utilization();
+
+    for (size_t stage_index = 0; stage_index < perceptron.get_stage_count(); stage_index++)
+    {
+        std::cout << "Stage " << stage_index << " (" << layer_counts[stage_index] << " layers) utilization: " << utilization[stage_index] * 100 << "%" << std::endl;
+    }
+}
+
+void serve(OnlinePerceptron &perceptron)
+{
+    std::vector<bitImage> validation_images;
+    for (auto &validation_path : std::filesystem::directory_iterator(validation_directory))
+    {
+        validation_images.push_back(readImage(validation_path.path()));
+    }
+
+    std::vector<LabeledSample> training_samples;
+    for (auto &train_path : std::filesystem::directory_iterator(training_directory))
+    {
+        bitImage image = readImage(train_path.path());
+        training_samples.push_back({image.data, image.type});
+    }
+
+    std::atomic<bool> serving(true);
+    std::atomic<bool> training(false);
+    std::vector<std::vector<double>> idle_latencies(online_reader_count);
+    std::vector<std::vector<double>> training_latencies(online_reader_count);
+    std::vector<std::thread> readers;
+
+    for (size_t reader_index = 0; reader_index < online_reader_count; reader_index++)
+    {
+        readers.emplace_back([&, reader_index]()
+        {
+            for (size_t image_index = 0; serving; image_index = (image_index + 1) % validation_images.size())
+            {
+                std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+                bool is_training = training;
+                perceptron.run(validation_images[image_index].data);
+                double latency = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+                if (is_training)
+                    training_latencies[reader_index].push_back(latency);
+                else
+                    idle_latencies[reader_index].push_back(latency);
+            }
+        });
+    }
+
+    // Serve with the trainer running but idle first, so the latency while
+    // training and publishing can be compared against it.
+    perceptron.start();
+    std::this_thread::sleep_for(online_idle_time);
+    training = true;
+
+    for (size_t epoch = 0; epoch < online_epoch_amount; epoch++)
+    {
+        for (LabeledSample &sample : training_samples)
+        {
+            LabeledSample queued_sample = sample;
+            while (!perceptron.learn(std::move(queued_sample)))
+            {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+    while (perceptron.get_trained_count() < online_epoch_amount * training_samples.size())
+    {
+        std::this_thread::yield();
+    }
+
+    perceptron.stop();
+    serving = false;
+
+    for (std::thread &reader : readers)
+    {
+        reader.join();
+    }
+
+    std::vector<double> all_idle_latencies;
+    std::vector<double> all_training_latencies;
+    for (size_t reader_index = 0; reader_index < online_reader_count; reader_index++)
+    {
+        all_idle_latencies.insert(all_idle_latencies.end(), idle_latencies[reader_index].begin(), idle_latencies[reader_index].end());
+        all_training_latencies.insert(all_training_latencies.end(), training_latencies[reader_index].begin(), training_latencies[reader_index].end());
+    }
+    std::sort(all_idle_latencies.begin(), all_idle_latencies.end());
+    std::sort(all_training_latencies.begin(), all_training_latencies.end());
+
+    int success_count = 0;
+    for (bitImage &image : validation_images)
+    {
+        std::vector<double> output = perceptron.run(image.data);
+        if (get_error(image.type, output) <= max_validation_error)
+            success_count++;
+    }
+    double success_rate = (double)(success_count) / (double)(validation_images.size()) * 100;
+
+    std::cout << "Online learning trained on " << perceptron.get_trained_count() << " samples and published version " << perceptron.get_version() << " | Validation: " << success_rate << "% of correct results" << std::endl;
+    std::cout << "Served " << all_idle_latencies.size() << " predictions with the trainer idle | p50 latency: " << all_idle_latencies[all_idle_latencies.size() / 2] << " | p99 latency: " << all_idle_latencies[all_idle_latencies.size() * 99 / 100] << std::endl;
+    std::cout << "Served " << all_training_latencies.size() << " predictions while training | p50 latency: " << all_training_latencies[all_training_latencies.size() / 2] << " | p99 latency: " << all_training_latencies[all_training_latencies.size() * 99 / 100] << std::endl;
+}
+
+bool compare(Perceptron &perceptron, model &perceptron_model, CompiledModel compiled_model)
+{
+    std::vector<bitImage> validation_images;
+    for (auto &validation_path : std::filesystem::directory_iterator(validation_directory))
+    {
+        validation_images.push_back(readImage(validation_path.path()));
+    }
+
+    perceptron.set_input(validation_images.front().data);
+    perceptron.set_expected_output(validation_images.front().type);
+    perceptron.set_weights(perceptron_model.weights);
+
+    double max_difference = 0;
+    int success_count = 0;
+    std::vector<double> output(perceptron_model.output_size);
+
+    for (bitImage &image : validation_images)
+    {
+        perceptron.set_input(image.data);
+        perceptron.set_expected_output(image.type);
+        perceptron.run();
+
+        compiled_model(image.data.data(), output.data());
+
+        std::vector<double> interpreted_output = perceptron.get_output();
+        for (size_t output_index = 0; output_index < output.size(); output_index++)
+        {
+            max_difference = std::max(max_difference, fabs(interpreted_output[output_index] - output[output_index]));
+        }
+
+        if (get_error(image.type, output) <= max_validation_error)
+            success_count++;
+    }
+
+    // The interpreter clamps inputs to [0,1], so values outside that range must
+    // give the same output from the compiled model too.
+    std::vector<double> out_of_range_input = validation_images.front().data;
+    for (double &value : out_of_range_input)
+    {
+        value = value > 0 ? 2 : -1;
+    }
+
+    perceptron.set_input(out_of_range_input);
+    perceptron.run();
+    compiled_model(out_of_range_input.data(), output.data());
+
+    std::vector<double> interpreted_output = perceptron.get_output();
+    for (size_t output_index = 0; output_index < output.size(); output_index++)
+    {
+        max_difference = std::max(max_difference, fabs(interpreted_output[output_index] - output[output_index]));
+    }
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for (size_t repeat = 0; repeat < compiled_model_repeat; repeat++)
+    {
+        for (bitImage &image : validation_images)
+        {
+            perceptron.set_input(image.data);
+            perceptron.run();
+        }
+    }
+    double interpreted_time = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    start = std::chrono::steady_clock::now();
+    for (size_t repeat = 0; repeat < compiled_model_repeat; repeat++)
+    {
+        for (bitImage &image : validation_images)
+        {
+            compiled_model(image.data.data(), output.data());
+        }
+    }
+    double compiled_time = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    size_t call_count = compiled_model_repeat * validation_images.size();
+    double success_rate = (double)(success_count) / (double)(validation_images.size()) * 100;
+
+    std::cout << "Compiled model ended with " << success_rate << "% of correct results | Max difference from interpreter: " << std::scientific << max_difference << std::fixed << std::endl;
+    std::cout << "Mean output time: interpreted " << interpreted_time / call_count << " | compiled " << compiled_time / call_count << std::endl;
+
+    if (max_difference != 0)
+    {
+        std::cerr << "MISMATCH: compiled model differs from the interpreter by " << std::scientific << max_difference << std::fixed << std::endl;
+        return false;
+    }
+
+    return true;
+}
+
 int main(void){
+    std::unique_ptr<Profiler> phase_profiler;
+    if (profiling_enabled)
+    {
+        phase_profiler = std::make_unique<Profiler>();
+        profiler = phase_profiler.get();
+    }
+
     Perceptron training_perceptron(
         input_size, 
         output_size, 
@@ -243,6 +630,9 @@ int main(void){
         min_learning_factor,
         max_learning_factor
     );
+    training_perceptron.set_seed(initialization_seed);
+    training_perceptron.set_initialization(initialization);
+    training_perceptron.set_profiler(profiler);
 
     train(training_perceptron);
     training_perceptron.debug_print_neuron_values();
@@ -259,7 +649,69 @@ int main(void){
         perceptron_model.hidden_layer_size
     );
 
+    validation_perceptron.set_profiler(profiler);
+
     validate(validation_perceptron, perceptron_model, false);
 
-    return 0;
+    if (profiler)
+    {
+        printSeparator();
+        profiler->print();
+        profiler->export_csv(profile_file);
+        profiler = nullptr;
+    }
+
+    printSeparator();
+
+    ModelCompiler model_compiler(
+        perceptron_model.input_size,
+        perceptron_model.output_size,
+        perceptron_model.layer_count,
+        perceptron_model.hidden_layer_size,
+        perceptron_model.weights
+    );
+
+    CompiledModel compiled_model = model_compiler.compile(compiled_model_directory);
+
+    int exit_code = 0;
+
+    if (!compiled_model || !compare(validation_perceptron, perceptron_model, compiled_model))
+        exit_code = 1;
+
+    for (double sparsity : pruning_sparsities)
+    {
+        printSeparator();
+        prune(perceptron_model, sparsity);
+    }
+
+    printSeparator();
+
+    PipelinedPerceptron pipelined_perceptron(
+        perceptron_model.input_size,
+        perceptron_model.output_size,
+        perceptron_model.layer_count,
+        perceptron_model.hidden_layer_size,
+        perceptron_model.weights,
+        pipeline_stage_count
+    );
+
+    stream(pipelined_perceptron);
+
+    printSeparator();
+
+    OnlinePerceptron online_perceptron(
+        perceptron_model.input_size,
+        perceptron_model.output_size,
+        perceptron_model.layer_count,
+        perceptron_model.hidden_layer_size,
+        perceptron_model.weights,
+        max_learning_error,
+        min_learning_factor,
+        max_learning_factor,
+        online_publish_interval
+    );
+
+    serve(online_perceptron);
+
+    return exit_code;
 }
\ No newline at end of file
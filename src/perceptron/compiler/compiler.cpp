@@ -0,0 +1,130 @@
+#include "compiler.hpp"
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <iostream>
+#include <dlfcn.h>
+
+constexpr const char *compiled_model_symbol = "perceptron_compiled_model";
+constexpr const char *compile_command = "g++ -std=c++20 -O2 -march=native -ffp-contract=off -shared -fPIC -o ";
+
+ModelCompiler::ModelCompiler
+(
+    size_t input_size,
+    size_t output_size,
+    size_t layer_count,
+    size_t hidden_layer_size,
+    std::vector<std::vector<double>> &weights
+) :
+    input_size(input_size),
+    output_size(output_size),
+    layer_count(layer_count),
+    hidden_layer_size(hidden_layer_size),
+    weights(weights),
+    library(nullptr) {};
+
+ModelCompiler::~ModelCompiler()
+{
+    if (this->library)
+        dlclose(this->library);
+}
+
+std::string ModelCompiler::generate_source()
+{
+    std::ostringstream source;
+
+    // Hexadecimal floats keep the baked weights bit-identical to the model, and
+    // the sums keep the interpreter's order, so the outputs match exactly.
+    source << std::hexfloat;
+    source << "#include <cmath>" << std::endl << std::endl;
+    source << "extern \"C\" void " << compiled_model_symbol << "(const double *__restrict input, double *__restrict output)" << std::endl;
+    source << "{" << std::endl;
+
+    // Inputs are clamped to [0,1] exactly like Neuron::set_value.
+    source << "    double layer_0[" << this->input_size << "];" << std::endl;
+    source << "    for (int index = 0; index < " << this->input_size << "; index++)" << std::endl;
+    source << "        layer_0[index] = input[index] <= 1 && input[index] >= 0 ? input[index] : (input[index] > 1 ? 1 : 0);" << std::endl;
+
+    std::string previous_layer = "layer_0";
+    size_t neuron_weight_index = 0;
+
+    for (size_t layer_index = 1; layer_index < this->layer_count; layer_index++)
+    {
+        bool is_output_layer = layer_index == this->layer_count - 1;
+        size_t layer_size = is_output_layer ? this->output_size : this->hidden_layer_size;
+        std::string layer = is_output_layer ? "output" : "layer_" + std::to_string(layer_index);
+
+        if (!is_output_layer)
+            source << "    double " << layer << "[" << layer_size << "];" << std::endl;
+
+        for (size_t neuron_index = 0; neuron_index < layer_size; neuron_index++)
+        {
+            std::vector<double> &neuron_weights = this->weights[neuron_weight_index++];
+
+            source << "    " << layer << "[" << neuron_index << "] = 1 / (1 + exp(-(0.0";
+
+            for (size_t input_index = 0; input_index < neuron_weights.size(); input_index++)
+            {
+                if (neuron_weights[input_index] == 0)
+                    continue;
+
+                source << " + " << neuron_weights[input_index] << " * " << previous_layer << "[" << input_index << "]";
+            }
+
+            source << ")));" << std::endl;
+        }
+
+        previous_layer = layer;
+    }
+
+    source << "}" << std::endl;
+
+    return source.str();
+}
+
+static std::string shell_quote(std::string value)
+{
+    std::string quoted = "'";
+
+    for (char character : value)
+    {
+        if (character == '\'')
+            quoted += "'\\''";
+        else
+            quoted += character;
+    }
+
+    return quoted + "'";
+}
+
+CompiledModel ModelCompiler::compile(std::string build_directory)
+{
+    std::string source_path = build_directory + "/compiled_model.cpp";
+    std::string library_path = build_directory + "/compiled_model.so";
+
+    std::ofstream file;
+    file.open(source_path);
+    file << this->generate_source();
+    file.close();
+
+    std::string command = compile_command + shell_quote(library_path) + " " + shell_quote(source_path);
+
+    if (std::system(command.c_str()) != 0)
+    {
+        std::cerr << "Model compilation failed: " << command << std::endl;
+        return nullptr;
+    }
+
+    if (this->library)
+        dlclose(this->library);
+
+    this->library = dlopen(library_path.c_str(), RTLD_NOW | RTLD_LOCAL);
+
+    if (!this->library)
+    {
+        std::cerr << "Model loading failed: " << dlerror() << std::endl;
+        return nullptr;
+    }
+
+    return (CompiledModel)dlsym(this->library, compiled_model_symbol);
+}
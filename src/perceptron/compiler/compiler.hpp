@@ -0,0 +1,37 @@
+#pragma once
+#include <stddef.h>
+#include <vector>
+#include <string>
+
+typedef void (*CompiledModel)(const double *input, double *output);
+
+// Turns a fixed model into a native function: the source is generated with
+// every layer unrolled and every weight baked in as a constant, built into a
+// shared library by the system compiler and loaded back with dlopen.
+//
+// The returned CompiledModel points into that library: it becomes invalid
+// when the ModelCompiler is destroyed or when compile() is called again.
+// compile() overwrites compiled_model.cpp and compiled_model.so in the build
+// directory and returns nullptr if building or loading fails.
+class ModelCompiler{
+    public:
+        ModelCompiler
+        (
+            size_t input_size,
+            size_t output_size,
+            size_t layer_count,
+            size_t hidden_layer_size,
+            std::vector<std::vector<double>> &weights
+        );
+        ~ModelCompiler();
+        std::string generate_source();
+        CompiledModel compile(std::string build_directory);
+
+    private:
+        size_t input_size;
+        size_t output_size;
+        size_t layer_count;
+        size_t hidden_layer_size;
+        std::vector<std::vector<double>> weights;
+        void *library;
+};
@@ -0,0 +1,83 @@
+#include "dense.hpp"
+
+std::vector<WeightLayer> split_weight_layers
+(
+    std::vector<std::vector<double>> &weights,
+    size_t input_size,
+    size_t output_size,
+    size_t layer_count,
+    size_t hidden_layer_size
+)
+{
+    std::vector<WeightLayer> layers;
+    size_t neuron_weight_index = 0;
+
+    for (size_t layer_index = 1; layer_index < layer_count; layer_index++)
+    {
+        size_t layer_size = layer_index == layer_count - 1 ? output_size : hidden_layer_size;
+        size_t previous_layer_size = layer_index == 1 ? input_size : hidden_layer_size;
+
+        WeightLayer layer;
+        layer.rows.assign(weights.begin() + neuron_weight_index, weights.begin() + neuron_weight_index + layer_size);
+        layer.column_count = previous_layer_size;
+        layers.push_back(layer);
+
+        neuron_weight_index += layer_size;
+    }
+
+    return layers;
+}
+
+DenseMatrix::DenseMatrix(std::vector<std::vector<double>> &rows, size_t column_count) :
+    row_count(rows.size()),
+    column_count(column_count)
+{
+    this->values.reserve(this->row_count * this->column_count);
+
+    for (std::vector<double> &row : rows)
+    {
+        this->values.insert(this->values.end(), row.begin(), row.end());
+    }
+}
+
+std::vector<double> DenseMatrix::multiply(const std::vector<double> &vector) const
+{
+    std::vector<double> result(this->row_count);
+
+    for (size_t row_index = 0; row_index < this->row_count; row_index++)
+    {
+        const double *row = &this->values[row_index * this->column_count];
+        double sum = 0;
+
+        for (size_t column_index = 0; column_index < this->column_count; column_index++)
+        {
+            sum += row[column_index] * vector[column_index];
+        }
+        result[row_index] = sum;
+    }
+
+    return result;
+}
+
+std::vector<std::vector<double>> DenseMatrix::multiply(const std::vector<std::vector<double>> &batch) const
+{
+    std::vector<std::vector<double>> result;
+    result.reserve(batch.size());
+
+    for (const std::vector<double> &sample : batch)
+    {
+        result.push_back(this->multiply(sample));
+    }
+
+    return result;
+}
+
+size_t DenseMatrix::get_row_count() const
+{
+    return this->row_count;
+}
+
+size_t DenseMatrix::get_column_count() const
+{
+    return this->column_count;
+}
@@ -0,0 +1,35 @@
+#pragma once
+#include <stddef.h>
+#include <vector>
+#include <cstdint>
+
+struct WeightLayer
+{
+    std::vector<std::vector<double>> rows;
+    size_t column_count;
+};
+
+// Splits the flat per-neuron output of Perceptron::get_weights() into one
+// row block per layer.
+std::vector<WeightLayer> split_weight_layers
+(
+    std::vector<std::vector<double>> &weights,
+    size_t input_size,
+    size_t output_size,
+    size_t layer_count,
+    size_t hidden_layer_size
+);
+
+class DenseMatrix{
+    public:
+        DenseMatrix(std::vector<std::vector<double>> &rows, size_t column_count);
+        std::vector<double> multiply(const std::vector<double> &vector) const;
+        std::vector<std::vector<double>> multiply(const std::vector<std::vector<double>> &batch) const;
+        size_t get_row_count() const;
+        size_t get_column_count() const;
+
+    private:
+        size_t row_count;
+        size_t column_count;
+        std::vector<double> values;
+};
@@ -1,7 +1,7 @@
 #include "input.hpp"
 #include <iostream>
 
-Input::Input(Neuron &neuron) : neuron(neuron), weight((rand() / (double)RAND_MAX * 0.2) - 0.1){};
+Input::Input(Neuron &neuron, double weight) : neuron(neuron), weight(weight){};
 
 double Input::get_value()
 {
@@ -8,7 +8,7 @@ class Neuron;
 
 class Input{
     public:
-        Input(Neuron &neuron);
+        Input(Neuron &neuron, double weight);
         double get_value();
         void set_weight(double weight);
         double get_weight();
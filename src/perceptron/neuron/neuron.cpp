@@ -11,22 +11,12 @@ Neuron::Neuron()
 
 void Neuron::set_value(double value)
 {
-    if (value <= 1 && value >= 0)
-        this->value = value;
-    else if (value > 1)
-        this->value = 1;
-    else
-        this->value = 0;
+    this->value = clamp(value);
 }
 
 void Neuron::set_expected_value(double expected_value)
 {
-    if (expected_value <= 1 && expected_value >= 0)
-        this->expected_value = expected_value;
-    else if (expected_value > 1)
-        this->expected_value = 1;
-    else
-        this->expected_value = 0;
+    this->expected_value = clamp(expected_value);
 
     this->is_output = true;
 }
@@ -53,14 +43,15 @@ void Neuron::update_value()
     this->value = this->activation(_value);
 };
 
-void Neuron::set_input_neurons(std::vector<Neuron> &neurons)
+void Neuron::set_input_neurons(std::vector<Neuron> &neurons, const WeightInitializer &initializer, size_t neuron_index)
 {
     this->inputs.clear();
+    this->pruned_inputs.clear();
     this->inputs.reserve(neurons.size());
     
-    for(size_t neuron_index = 0; neuron_index < neurons.size(); neuron_index++)
+    for(size_t input_index = 0; input_index < neurons.size(); input_index++)
     {
-        Input input(neurons[neuron_index]);
+        Input input(neurons[input_index], initializer.get_weight(neuron_index, input_index));
         this->inputs.push_back(input);
     }
 };
@@ -75,6 +66,16 @@ double Neuron::activation(double value)
     return 1 / (1 + exp(-value));
 }
 
+double Neuron::clamp(double value)
+{
+    if (value <= 1 && value >= 0)
+        return value;
+    else if (value > 1)
+        return 1;
+    else
+        return 0;
+}
+
 void Neuron::update_learning_rule()
 {
     if (this->is_output)
@@ -94,9 +95,34 @@ double Neuron::get_learning_rule()
 
 void Neuron::update_weights(double learning_factor)
 {
-    for (Input &input : this->inputs)
+    for (size_t input_index = 0; input_index < this->inputs.size(); input_index++)
     {
+        if (this->is_input_pruned(input_index))
+            continue;
+
+        Input &input = this->inputs[input_index];
         double new_weight = input.get_weight() + learning_factor * this->learning_rule * input.get_neuron().value;
         input.set_weight(new_weight);
     }
 }
+
+void Neuron::prune_input(size_t input_index)
+{
+    // The mask is only allocated once something is pruned, so dense neurons
+    // keep the plain Input layout.
+    if (this->pruned_inputs.empty())
+        this->pruned_inputs.resize(this->inputs.size(), false);
+
+    this->inputs[input_index].set_weight(0);
+    this->pruned_inputs[input_index] = true;
+}
+
+void Neuron::clear_pruned_inputs()
+{
+    this->pruned_inputs.clear();
+}
+
+bool Neuron::is_input_pruned(size_t input_index)
+{
+    return !this->pruned_inputs.empty() && this->pruned_inputs[input_index];
+}
@@ -4,6 +4,7 @@
 #include <cstdint>
 #include <functional>
 #include "../input/input.hpp"
+#include "../random/random.hpp"
 
 class Input;
 
@@ -15,13 +16,17 @@ class Neuron{
         double get_value();
         double get_expected_value();
         void update_value();
-        void set_input_neurons(std::vector<Neuron> &neurons);
+        void set_input_neurons(std::vector<Neuron> &neurons, const WeightInitializer &initializer, size_t neuron_index);
         std::vector<Input> &get_inputs();
         static double activation(double value);
+        static double clamp(double value);
         void update_learning_rule();
         void update_learning_rule(double next_learning_rule_sum);
         double get_learning_rule();
         void update_weights(double learning_factor);
+        void prune_input(size_t input_index);
+        void clear_pruned_inputs();
+        bool is_input_pruned(size_t input_index);
 
     private:
         double value;
@@ -29,4 +34,5 @@ class Neuron{
         double expected_value;
         double learning_rule;
         std::vector<Input> inputs;
+        std::vector<bool> pruned_inputs;
 };
\ No newline at end of file
@@ -0,0 +1,188 @@
+#include "online.hpp"
+#include "../neuron/neuron.hpp"
+
+static std::atomic<size_t> next_reader_slot(0);
+
+OnlinePerceptron::OnlinePerceptron
+(
+    size_t input_size,
+    size_t output_size,
+    size_t layer_count,
+    size_t hidden_layer_size,
+    std::vector<std::vector<double>> &weights,
+    double max_error,
+    double min_learning_factor,
+    double max_learning_factor,
+    size_t publish_interval,
+    size_t buffer_capacity
+) :
+    input_size(input_size),
+    output_size(output_size),
+    layer_count(layer_count),
+    hidden_layer_size(hidden_layer_size),
+    publish_interval(publish_interval),
+    trainer(input_size, output_size, layer_count, hidden_layer_size, max_error, min_learning_factor, max_learning_factor),
+    samples(buffer_capacity),
+    running(false),
+    trained_count(0),
+    snapshot(nullptr),
+    epoch(0)
+{
+    this->trainer.set_input(std::vector<double>(input_size));
+    this->trainer.set_expected_output(std::vector<double>(output_size));
+    this->trainer.set_weights(weights);
+
+    this->publish();
+}
+
+OnlinePerceptron::~OnlinePerceptron()
+{
+    this->stop();
+    delete this->snapshot.load();
+}
+
+void OnlinePerceptron::start()
+{
+    if (this->running)
+        return;
+
+    this->running = true;
+    this->trainer_thread = std::thread(&OnlinePerceptron::run_trainer, this);
+}
+
+void OnlinePerceptron::stop()
+{
+    if (!this->running)
+        return;
+
+    this->running = false;
+    this->trainer_thread.join();
+}
+
+bool OnlinePerceptron::learn(LabeledSample &&sample)
+{
+    return this->samples.push(std::move(sample));
+}
+
+std::vector<double> OnlinePerceptron::run(const std::vector<double> &input)
+{
+    ReaderSlot &reader_slot = this->get_reader_slot();
+    size_t reader_epoch = this->epoch.load() & 1;
+    reader_slot.counts[reader_epoch].fetch_add(1);
+
+    const WeightSnapshot *snapshot = this->snapshot.load();
+    std::vector<double> values = input;
+    for (double &value : values)
+    {
+        value = Neuron::clamp(value);
+    }
+
+    for (const DenseMatrix &layer : snapshot->layers)
+    {
+        values = layer.multiply(values);
+        for (double &value : values)
+        {
+            value = Neuron::activation(value);
+        }
+    }
+
+    reader_slot.counts[reader_epoch].fetch_sub(1);
+
+    return values;
+}
+
+size_t OnlinePerceptron::get_version()
+{
+    ReaderSlot &reader_slot = this->get_reader_slot();
+    size_t reader_epoch = this->epoch.load() & 1;
+    reader_slot.counts[reader_epoch].fetch_add(1);
+
+    size_t version = this->snapshot.load()->version;
+
+    reader_slot.counts[reader_epoch].fetch_sub(1);
+
+    return version;
+}
+
+size_t OnlinePerceptron::get_trained_count()
+{
+    return this->trained_count;
+}
+
+void OnlinePerceptron::run_trainer()
+{
+    LabeledSample sample;
+    size_t unpublished_count = 0;
+
+    while (this->running)
+    {
+        if (!this->samples.pop(sample))
+        {
+            std::this_thread::yield();
+            continue;
+        }
+
+        this->trainer.set_input(sample.input);
+        this->trainer.set_expected_output(sample.expected_output);
+        this->trainer.train();
+
+        this->trained_count++;
+        unpublished_count++;
+
+        if (unpublished_count == this->publish_interval)
+        {
+            this->publish();
+            unpublished_count = 0;
+        }
+    }
+
+    if (unpublished_count > 0)
+        this->publish();
+}
+
+void OnlinePerceptron::publish()
+{
+    std::vector<std::vector<double>> weights = this->trainer.get_weights();
+    WeightSnapshot *snapshot = new WeightSnapshot();
+
+    for (WeightLayer &weight_layer : split_weight_layers(weights, this->input_size, this->output_size, this->layer_count, this->hidden_layer_size))
+    {
+        snapshot->layers.emplace_back(weight_layer.rows, weight_layer.column_count);
+    }
+
+    const WeightSnapshot *old_snapshot = this->snapshot.load();
+    snapshot->version = old_snapshot ? old_snapshot->version + 1 : 0;
+
+    this->snapshot.store(snapshot);
+
+    if (old_snapshot)
+    {
+        this->synchronize();
+        delete old_snapshot;
+    }
+}
+
+void OnlinePerceptron::synchronize()
+{
+    // A reader may have picked its counter from an epoch read just before the
+    // swap, so both counters of every slot are drained once after it.
+    for (size_t flip = 0; flip < 2; flip++)
+    {
+        size_t drained_epoch = this->epoch.fetch_add(1) & 1;
+
+        for (ReaderSlot &reader_slot : this->reader_slots)
+        {
+            while (reader_slot.counts[drained_epoch].load() != 0)
+            {
+                std::this_thread::yield();
+            }
+        }
+    }
+}
+
+ReaderSlot &OnlinePerceptron::get_reader_slot()
+{
+    thread_local size_t reader_slot_index = next_reader_slot.fetch_add(1) % reader_slot_count;
+
+    return this->reader_slots[reader_slot_index];
+}
@@ -0,0 +1,85 @@
+#pragma once
+#include <stddef.h>
+#include <vector>
+#include <cstdint>
+#include <atomic>
+#include <thread>
+#include "../perceptron.hpp"
+#include "../dense/dense.hpp"
+#include "../pipeline/ring_buffer.hpp"
+
+struct LabeledSample
+{
+    std::vector<double> input;
+    std::vector<double> expected_output;
+};
+
+struct WeightSnapshot
+{
+    size_t version;
+    std::vector<DenseMatrix> layers;
+};
+
+constexpr size_t reader_slot_count = 64;
+
+// Each reader thread counts itself in its own cache line, so readers do not
+// contend with each other. Threads beyond reader_slot_count share slots.
+struct alignas(64) ReaderSlot
+{
+    std::atomic<size_t> counts[2] = {0, 0};
+};
+
+// Trains a private Perceptron on a background thread while run() serves
+// predictions from an immutable snapshot of the weights. Snapshots are swapped
+// in RCU style: readers only bump a per-epoch counter in their own slot and
+// never wait, the trainer waits for readers of the old snapshot to drain
+// before freeing it.
+//
+// run() and get_version() may be called from any number of threads. learn()
+// is the producer side of a single-producer queue: only one thread may ever
+// call it. It takes the sample only when it returns true.
+class OnlinePerceptron{
+    public:
+        OnlinePerceptron
+        (
+            size_t input_size,
+            size_t output_size,
+            size_t layer_count,
+            size_t hidden_layer_size,
+            std::vector<std::vector<double>> &weights,
+            double max_error,
+            double min_learning_factor,
+            double max_learning_factor,
+            size_t publish_interval=64,
+            size_t buffer_capacity=1024
+        );
+        ~OnlinePerceptron();
+        void start();
+        void stop();
+        bool learn(LabeledSample &&sample);
+        std::vector<double> run(const std::vector<double> &input);
+        size_t get_version();
+        size_t get_trained_count();
+
+    private:
+        void run_trainer();
+        void publish();
+        void synchronize();
+        ReaderSlot &get_reader_slot();
+
+        size_t input_size;
+        size_t output_size;
+        size_t layer_count;
+        size_t hidden_layer_size;
+        size_t publish_interval;
+
+        Perceptron trainer;
+        RingBuffer<LabeledSample> samples;
+        std::thread trainer_thread;
+        std::atomic<bool> running;
+        std::atomic<size_t> trained_count;
+
+        std::atomic<const WeightSnapshot *> snapshot;
+        alignas(64) std::atomic<size_t> epoch;
+        ReaderSlot reader_slots[reader_slot_count];
+};
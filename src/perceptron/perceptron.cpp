@@ -3,6 +3,9 @@
 #include <algorithm>
 #include <vector>
 #include <iostream>
+#include <thread>
+
+constexpr size_t parallel_initialization_weight_count = 1 << 16;
 
 Perceptron::Perceptron
 (
@@ -20,7 +23,10 @@ Perceptron::Perceptron
     hidden_layer_size(intermediate_layer_size),
     max_error(max_error),
     min_learning_factor(min_learning_factor),
-    max_learning_factor(max_learning_factor) {};
+    max_learning_factor(max_learning_factor),
+    seed(0),
+    initializations(layer_count, Initialization::Uniform),
+    profiler(nullptr) {};
 
 void Perceptron::set_input(std::vector<double> input)
 {
@@ -34,7 +40,8 @@ void Perceptron::set_expected_output(std::vector<double> expected_output)
 
 void Perceptron::set_weights(std::vector<std::vector<double>> &weights)
 { 
-    this->initialize_neurons();
+    if (this->neuron_layers.size() != this->layer_count)
+        this->initialize_neurons();
 
     size_t neuron_weight_index = 0;
 
@@ -46,6 +53,7 @@ void Perceptron::set_weights(std::vector<std::vector<double>> &weights)
         {
             Neuron &neuron = layer[neuron_index];
             std::vector<Input> &inputs = neuron.get_inputs();
+            neuron.clear_pruned_inputs();
 
             for(size_t input_index = 0; input_index < neuron.get_inputs().size(); input_index++)
             {
@@ -57,6 +65,26 @@ void Perceptron::set_weights(std::vector<std::vector<double>> &weights)
     }
 }
 
+void Perceptron::set_seed(uint64_t seed)
+{
+    this->seed = seed;
+}
+
+void Perceptron::set_initialization(Initialization initialization)
+{
+    std::fill(this->initializations.begin(), this->initializations.end(), initialization);
+}
+
+void Perceptron::set_initialization(size_t layer_index, Initialization initialization)
+{
+    this->initializations[layer_index] = initialization;
+}
+
+void Perceptron::set_profiler(Profiler *profiler)
+{
+    this->profiler = profiler;
+}
+
 std::vector<std::vector<double>> Perceptron::get_weights()
 {
     std::vector<std::vector<double>> weights;
@@ -81,6 +109,50 @@ std::vector<std::vector<double>> Perceptron::get_weights()
     return weights;
 }
 
+void Perceptron::prune(double sparsity, bool per_layer)
+{
+    std::vector<std::vector<double>> weights = this->get_weights();
+    std::vector<double> thresholds(this->layer_count, 0);
+    std::vector<double> magnitudes;
+
+    size_t neuron_weight_index = 0;
+
+    for(size_t layer_index = 1; layer_index < this->layer_count; layer_index++)
+    {
+        if (per_layer)
+            magnitudes.clear();
+
+        for(size_t neuron_index = 0; neuron_index < this->neuron_layers[layer_index].size(); neuron_index++)
+        {
+            for(double weight : weights[neuron_weight_index])
+            {
+                magnitudes.push_back(fabs(weight));
+            }
+            neuron_weight_index++;
+        }
+
+        if (per_layer)
+            thresholds[layer_index] = magnitude_threshold(magnitudes, sparsity);
+    }
+
+    if (!per_layer)
+        std::fill(thresholds.begin(), thresholds.end(), magnitude_threshold(magnitudes, sparsity));
+
+    for(size_t layer_index = 1; layer_index < this->layer_count; layer_index++)
+    {
+        for(Neuron &neuron : this->neuron_layers[layer_index])
+        {
+            std::vector<Input> &inputs = neuron.get_inputs();
+
+            for(size_t input_index = 0; input_index < inputs.size(); input_index++)
+            {
+                if (fabs(inputs[input_index].get_weight()) < thresholds[layer_index])
+                    neuron.prune_input(input_index);
+            }
+        }
+    }
+}
+
 double Perceptron::get_error()
 {
     return this->error;
@@ -103,15 +175,18 @@ void Perceptron::train()
     else 
         this->initialize_neurons();
 
-    this->calculate_neurons();
+    if (this->profiler)
+        this->profiler->add_sample();
+
+    this->profile(ProfilePhase::CalculateNeurons, &Perceptron::calculate_neurons);
 
     this->update_learning_factor();
     this->update_error();
 
     if (this->error > max_error)
     {
-        this->update_learning_rules();
-        this->update_weights();
+        this->profile(ProfilePhase::UpdateLearningRules, &Perceptron::update_learning_rules);
+        this->profile(ProfilePhase::UpdateWeights, &Perceptron::update_weights);
     }
 }
 
@@ -122,7 +197,10 @@ void Perceptron::run()
     else 
         this->initialize_neurons();
 
-    this->calculate_neurons();
+    if (this->profiler)
+        this->profiler->add_sample();
+
+    this->profile(ProfilePhase::CalculateNeurons, &Perceptron::calculate_neurons);
     this->update_error();
 }
 
@@ -169,18 +247,53 @@ void Perceptron::initialize_neurons()
             for(size_t neuron_index = 0; neuron_index < this->output_size; neuron_index++)
             {
                 this->neuron_layers[layer_index][neuron_index].set_expected_value(this->expected_output[neuron_index]);
-                this->neuron_layers[layer_index][neuron_index].set_input_neurons(this->neuron_layers[layer_index - 1]);
             }
+            this->initialize_inputs(layer_index);
         }
         else 
         {
             this->neuron_layers[layer_index].resize(this->hidden_layer_size);
+            this->initialize_inputs(layer_index);
+        }
+    }
+}
 
-            for(size_t neuron_index = 0; neuron_index < this->hidden_layer_size; neuron_index++)
-            {
-                this->neuron_layers[layer_index][neuron_index].set_input_neurons(this->neuron_layers[layer_index - 1]);
-            }
+void Perceptron::initialize_inputs(size_t layer_index)
+{
+    std::vector<Neuron> &layer = this->neuron_layers[layer_index];
+    std::vector<Neuron> &previous_layer = this->neuron_layers[layer_index - 1];
+
+    WeightInitializer initializer(this->seed, this->initializations[layer_index], layer_index, previous_layer.size(), layer.size());
+
+    auto initialize_range = [&](size_t first_neuron_index, size_t last_neuron_index)
+    {
+        for(size_t neuron_index = first_neuron_index; neuron_index < last_neuron_index; neuron_index++)
+        {
+            layer[neuron_index].set_input_neurons(previous_layer, initializer, neuron_index);
         }
+    };
+
+    size_t thread_count = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+
+    if (layer.size() * previous_layer.size() < parallel_initialization_weight_count || thread_count == 1)
+    {
+        initialize_range(0, layer.size());
+        return;
+    }
+
+    // Weights depend only on (seed, layer, neuron, input), so the split between
+    // threads does not change the result.
+    std::vector<std::thread> threads;
+    size_t chunk_size = (layer.size() + thread_count - 1) / thread_count;
+
+    for(size_t first_neuron_index = 0; first_neuron_index < layer.size(); first_neuron_index += chunk_size)
+    {
+        threads.emplace_back(initialize_range, first_neuron_index, std::min(first_neuron_index + chunk_size, layer.size()));
+    }
+
+    for(std::thread &thread : threads)
+    {
+        thread.join();
     }
 }
 
@@ -280,4 +393,30 @@ void Perceptron::update_weights()
             neuron.update_weights(this->learning_factor);
         }
     }
+}
+
+double Perceptron::magnitude_threshold(std::vector<double> &magnitudes, double sparsity)
+{
+    if (magnitudes.empty() || sparsity <= 0)
+        return 0;
+
+    size_t pruned_count = (size_t)(sparsity * magnitudes.size());
+
+    if (pruned_count >= magnitudes.size())
+        return INFINITY;
+
+    std::nth_element(magnitudes.begin(), magnitudes.begin() + pruned_count, magnitudes.end());
+
+    return magnitudes[pruned_count];
+}
+
+void Perceptron::profile(ProfilePhase phase, void (Perceptron::*step)())
+{
+    if (this->profiler)
+        this->profiler->begin(phase);
+
+    (this->*step)();
+
+    if (this->profiler)
+        this->profiler->end(phase);
 }
\ No newline at end of file
@@ -5,6 +5,8 @@
 #include <functional>
 #include "neuron/neuron.hpp"
 #include "input/input.hpp"
+#include "random/random.hpp"
+#include "profiler/profiler.hpp"
 
 class Perceptron {
     public:
@@ -20,8 +22,14 @@ class Perceptron {
         );
         void set_input(std::vector<double> input);
         void set_expected_output(std::vector<double> expected_output);
+        // Writes every weight and clears any pruning mask left by prune().
         void set_weights(std::vector<std::vector<double>> &weights);
+        void set_seed(uint64_t seed);
+        void set_initialization(Initialization initialization);
+        void set_initialization(size_t layer_index, Initialization initialization);
+        void set_profiler(Profiler *profiler);
         std::vector<std::vector<double>> get_weights();
+        void prune(double sparsity, bool per_layer=false);
         double get_error();
         std::vector<double> get_output();
         void train();
@@ -32,11 +40,14 @@ class Perceptron {
     private:
         void initialize_neurons();
         void reset_neurons();
+        void initialize_inputs(size_t layer_index);
         void calculate_neurons();
         void update_error();
         void update_learning_factor();
         void update_learning_rules();
         void update_weights();
+        void profile(ProfilePhase phase, void (Perceptron::*step)());
+        static double magnitude_threshold(std::vector<double> &magnitudes, double sparsity);
 
         size_t input_size;
         size_t output_size;
@@ -51,5 +62,8 @@ class Perceptron {
         double min_learning_factor;
         double max_learning_factor;
         double learning_factor;
+        uint64_t seed;
+        std::vector<Initialization> initializations;
+        Profiler *profiler;
         std::vector<std::vector<Neuron>> neuron_layers;
 };
\ No newline at end of file
@@ -0,0 +1,225 @@
+#include "pipeline.hpp"
+#include "../neuron/neuron.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+PipelinedPerceptron::PipelinedPerceptron
+(
+    size_t input_size,
+    size_t output_size,
+    size_t layer_count,
+    size_t hidden_layer_size,
+    std::vector<std::vector<double>> &weights,
+    size_t stage_count,
+    size_t buffer_capacity
+) : running(false)
+{
+    std::vector<DenseMatrix> layers;
+
+    for (WeightLayer &weight_layer : split_weight_layers(weights, input_size, output_size, layer_count, hidden_layer_size))
+    {
+        layers.emplace_back(weight_layer.rows, weight_layer.column_count);
+    }
+
+    stage_count = std::clamp<size_t>(stage_count, 1, layers.size());
+
+    double total_cost = 0;
+    for (DenseMatrix &layer : layers)
+    {
+        total_cost += layer.get_row_count() * layer.get_column_count();
+    }
+
+    // Split the layers into contiguous groups of roughly equal weight count,
+    // keeping at least one layer per stage.
+    this->stages.push_back(std::make_unique<PipelineStage>());
+    double accumulated_cost = 0;
+
+    for (size_t layer_index = 0; layer_index < layers.size(); layer_index++)
+    {
+        double cost = layers[layer_index].get_row_count() * layers[layer_index].get_column_count();
+        size_t remaining_layers = layers.size() - layer_index;
+        size_t remaining_stages = stage_count - this->stages.size();
+        bool is_stage_full = accumulated_cost + cost / 2 > total_cost * this->stages.size() / stage_count;
+
+        if (!this->stages.back()->layers.empty() && remaining_stages > 0 && (is_stage_full || remaining_layers == remaining_stages))
+            this->stages.push_back(std::make_unique<PipelineStage>());
+
+        this->stages.back()->layers.push_back(layers[layer_index]);
+        accumulated_cost += cost;
+    }
+
+    for (size_t buffer_index = 0; buffer_index <= this->stages.size(); buffer_index++)
+    {
+        this->buffers.push_back(std::make_unique<RingBuffer<ActivationBatch>>(buffer_capacity));
+    }
+}
+
+PipelinedPerceptron::~PipelinedPerceptron()
+{
+    this->stop();
+}
+
+void PipelinedPerceptron::start()
+{
+    if (this->running)
+        return;
+
+    this->running = true;
+    this->start_time = std::chrono::steady_clock::now();
+
+#ifdef __linux__
+    // Only pin to CPUs this process may run on (cgroups, taskset). When there
+    // are spare CPUs, the first one is left to the thread feeding the pipeline.
+    std::vector<int> allowed_cpus;
+    cpu_set_t process_cpu_set;
+
+    if (sched_getaffinity(0, sizeof(cpu_set_t), &process_cpu_set) == 0)
+    {
+        for (int cpu = 0; cpu < CPU_SETSIZE; cpu++)
+        {
+            if (CPU_ISSET(cpu, &process_cpu_set))
+                allowed_cpus.push_back(cpu);
+        }
+    }
+    else
+    {
+        std::cerr << "Pipeline stages are not pinned: " << strerror(errno) << std::endl;
+    }
+
+    size_t first_cpu_index = allowed_cpus.size() > this->stages.size() ? 1 : 0;
+#endif
+
+    for (size_t stage_index = 0; stage_index < this->stages.size(); stage_index++)
+    {
+        PipelineStage &stage = *this->stages[stage_index];
+        stage.busy_time = 0;
+        stage.thread = std::thread(&PipelinedPerceptron::run_stage, this, stage_index);
+
+#ifdef __linux__
+        if (allowed_cpus.empty())
+            continue;
+
+        int cpu = allowed_cpus[(first_cpu_index + stage_index) % allowed_cpus.size()];
+        cpu_set_t cpu_set;
+        CPU_ZERO(&cpu_set);
+        CPU_SET(cpu, &cpu_set);
+
+        int result = pthread_setaffinity_np(stage.thread.native_handle(), sizeof(cpu_set_t), &cpu_set);
+        if (result != 0)
+            std::cerr << "Pipeline stage " << stage_index << " could not be pinned to CPU " << cpu << ": " << strerror(result) << std::endl;
+#endif
+    }
+}
+
+void PipelinedPerceptron::stop()
+{
+    if (!this->running)
+        return;
+
+    this->running = false;
+
+    for (std::unique_ptr<PipelineStage> &stage : this->stages)
+    {
+        stage->thread.join();
+    }
+
+    this->stop_time = std::chrono::steady_clock::now();
+}
+
+bool PipelinedPerceptron::push(ActivationBatch &&batch)
+{
+    return this->buffers.front()->push(std::move(batch));
+}
+
+bool PipelinedPerceptron::pop(ActivationBatch &batch)
+{
+    return this->buffers.back()->pop(batch);
+}
+
+size_t PipelinedPerceptron::get_stage_count()
+{
+    return this->stages.size();
+}
+
+std::vector<size_t> PipelinedPerceptron::get_stage_layer_counts()
+{
+    std::vector<size_t> layer_counts;
+
+    for (std::unique_ptr<PipelineStage> &stage : this->stages)
+    {
+        layer_counts.push_back(stage->layers.size());
+    }
+
+    return layer_counts;
+}
+
+std::vector<double> PipelinedPerceptron::get_stage_utilization()
+{
+    std::chrono::steady_clock::time_point end_time = this->running ? std::chrono::steady_clock::now() : this->stop_time;
+    double elapsed_time = std::chrono::duration_cast<std::chrono::nanoseconds>(end_time - this->start_time).count();
+
+    std::vector<double> utilization;
+
+    for (std::unique_ptr<PipelineStage> &stage : this->stages)
+    {
+        utilization.push_back(elapsed_time > 0 ? stage->busy_time / elapsed_time : 0);
+    }
+
+    return utilization;
+}
+
+void PipelinedPerceptron::run_stage(size_t stage_index)
+{
+    PipelineStage &stage = *this->stages[stage_index];
+    RingBuffer<ActivationBatch> &input_buffer = *this->buffers[stage_index];
+    RingBuffer<ActivationBatch> &output_buffer = *this->buffers[stage_index + 1];
+
+    ActivationBatch batch;
+
+    while (this->running)
+    {
+        if (!input_buffer.pop(batch))
+        {
+            std::this_thread::yield();
+            continue;
+        }
+
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+        if (stage_index == 0)
+        {
+            for (std::vector<double> &sample : batch)
+            {
+                for (double &value : sample)
+                {
+                    value = Neuron::clamp(value);
+                }
+            }
+        }
+
+        for (DenseMatrix &layer : stage.layers)
+        {
+            batch = layer.multiply(batch);
+            for (std::vector<double> &sample : batch)
+            {
+                for (double &value : sample)
+                {
+                    value = Neuron::activation(value);
+                }
+            }
+        }
+
+        stage.busy_time += std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+
+        while (!output_buffer.push(std::move(batch)) && this->running)
+        {
+            std::this_thread::yield();
+        }
+    }
+}
@@ -0,0 +1,56 @@
+#pragma once
+#include <stddef.h>
+#include <vector>
+#include <cstdint>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+#include "ring_buffer.hpp"
+#include "../dense/dense.hpp"
+
+typedef std::vector<std::vector<double>> ActivationBatch;
+
+struct PipelineStage
+{
+    std::vector<DenseMatrix> layers;
+    std::thread thread;
+    std::atomic<int64_t> busy_time{0};
+};
+
+// Streams activation batches through groups of layers, each group running on
+// its own thread, so layer k processes batch i while layer k+1 processes i-1.
+// push() and pop() are the single producer and single consumer of the ring
+// buffers at either end; push() takes the batch only when it returns true. Batches come out in the order they went in. stop()
+// does not drain the pipeline: callers must pop every pushed batch before
+// calling it, otherwise batches still in flight are discarded.
+class PipelinedPerceptron{
+    public:
+        PipelinedPerceptron
+        (
+            size_t input_size,
+            size_t output_size,
+            size_t layer_count,
+            size_t hidden_layer_size,
+            std::vector<std::vector<double>> &weights,
+            size_t stage_count,
+            size_t buffer_capacity=8
+        );
+        ~PipelinedPerceptron();
+        void start();
+        void stop();
+        bool push(ActivationBatch &&batch);
+        bool pop(ActivationBatch &batch);
+        size_t get_stage_count();
+        std::vector<size_t> get_stage_layer_counts();
+        std::vector<double> get_stage_utilization();
+
+    private:
+        void run_stage(size_t stage_index);
+
+        std::vector<std::unique_ptr<PipelineStage>> stages;
+        std::vector<std::unique_ptr<RingBuffer<ActivationBatch>>> buffers;
+        std::atomic<bool> running;
+        std::chrono::steady_clock::time_point start_time;
+        std::chrono::steady_clock::time_point stop_time;
+};
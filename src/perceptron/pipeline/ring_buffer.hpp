@@ -0,0 +1,53 @@
+#pragma once
+#include <stddef.h>
+#include <vector>
+#include <atomic>
+#include <utility>
+
+// Lock-free single-producer/single-consumer queue. Exactly one thread may call
+// push() and exactly one (possibly different) thread may call pop(). push()
+// moves the value in only when it succeeds; on a full buffer the caller's
+// value is left untouched so it can be retried.
+template <typename T>
+class RingBuffer{
+    public:
+        RingBuffer(size_t capacity) : head(0), tail(0)
+        {
+            size_t slot_count = 1;
+            while (slot_count < capacity)
+                slot_count <<= 1;
+
+            this->slots.resize(slot_count);
+            this->mask = slot_count - 1;
+        }
+
+        bool push(T &&value)
+        {
+            size_t tail = this->tail.load(std::memory_order_relaxed);
+
+            if (tail - this->head.load(std::memory_order_acquire) == this->slots.size())
+                return false;
+
+            this->slots[tail & this->mask] = std::move(value);
+            this->tail.store(tail + 1, std::memory_order_release);
+            return true;
+        }
+
+        bool pop(T &value)
+        {
+            size_t head = this->head.load(std::memory_order_relaxed);
+
+            if (head == this->tail.load(std::memory_order_acquire))
+                return false;
+
+            value = std::move(this->slots[head & this->mask]);
+            this->head.store(head + 1, std::memory_order_release);
+            return true;
+        }
+
+    private:
+        std::vector<T> slots;
+        size_t mask;
+        alignas(64) std::atomic<size_t> head;
+        alignas(64) std::atomic<size_t> tail;
+};
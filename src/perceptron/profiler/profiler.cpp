@@ -0,0 +1,238 @@
+#include "profiler.hpp"
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <iomanip>
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+enum ProfileCounter {
+    Cycles,
+    Instructions,
+    L1Misses,
+    LLCMisses,
+    BranchMisses
+};
+
+constexpr const char *phase_names[profile_phase_count] = {
+    "data_loading",
+    "calculate_neurons",
+    "update_learning_rules",
+    "update_weights"
+};
+
+#ifdef __linux__
+static int open_counter(uint32_t type, uint64_t config, int group_fd)
+{
+    perf_event_attr attributes = {};
+    attributes.size = sizeof(perf_event_attr);
+    attributes.type = type;
+    attributes.config = config;
+    attributes.disabled = group_fd == -1;
+    attributes.exclude_kernel = 1;
+    attributes.exclude_hv = 1;
+    attributes.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+    return syscall(SYS_perf_event_open, &attributes, 0, -1, group_fd, 0);
+}
+
+static uint64_t cache_miss_config(uint64_t cache)
+{
+    return cache | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+}
+#endif
+
+Profiler::Profiler() :
+    group_fd(-1),
+    phase_starts{},
+    totals{},
+    call_counts{},
+    sample_count(0),
+    is_last_read_scaled(false),
+    is_last_read_unscheduled(false),
+    scaled_phases{},
+    unscheduled_phases{}
+{
+    this->counter_fds.fill(-1);
+
+#ifdef __linux__
+    this->group_fd = open_counter(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES, -1);
+    if (this->group_fd == -1)
+        return;
+
+    this->counter_fds[Cycles] = this->group_fd;
+    this->counter_fds[Instructions] = open_counter(PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS, this->group_fd);
+    this->counter_fds[L1Misses] = open_counter(PERF_TYPE_HW_CACHE, cache_miss_config(PERF_COUNT_HW_CACHE_L1D), this->group_fd);
+    this->counter_fds[LLCMisses] = open_counter(PERF_TYPE_HW_CACHE, cache_miss_config(PERF_COUNT_HW_CACHE_LL), this->group_fd);
+    this->counter_fds[BranchMisses] = open_counter(PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES, this->group_fd);
+
+    ioctl(this->group_fd, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+    ioctl(this->group_fd, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+#endif
+}
+
+Profiler::~Profiler()
+{
+#ifdef __linux__
+    for (int counter_fd : this->counter_fds)
+    {
+        if (counter_fd != -1)
+            close(counter_fd);
+    }
+#endif
+}
+
+bool Profiler::is_available()
+{
+    return this->group_fd != -1;
+}
+
+void Profiler::begin(ProfilePhase phase)
+{
+    if (!this->is_available())
+        return;
+
+    this->phase_starts[(size_t)phase] = this->read_counters();
+}
+
+void Profiler::end(ProfilePhase phase)
+{
+    if (!this->is_available())
+        return;
+
+    std::array<uint64_t, profile_counter_count> phase_end = this->read_counters();
+    std::array<uint64_t, profile_counter_count> &total = this->totals[(size_t)phase];
+
+    for (size_t counter_index = 0; counter_index < profile_counter_count; counter_index++)
+    {
+        total[counter_index] += phase_end[counter_index] - this->phase_starts[(size_t)phase][counter_index];
+    }
+    this->call_counts[(size_t)phase]++;
+
+    if (this->is_last_read_scaled)
+        this->scaled_phases[(size_t)phase] = true;
+    if (this->is_last_read_unscheduled)
+        this->unscheduled_phases[(size_t)phase] = true;
+}
+
+void Profiler::add_sample()
+{
+    this->sample_count++;
+}
+
+void Profiler::print()
+{
+    if (!this->is_available())
+    {
+        std::cout << "Hardware performance counters are unavailable" << std::endl;
+        return;
+    }
+
+    double sample_count = std::max<size_t>(this->sample_count, 1);
+
+    std::cout << "Profiled " << this->sample_count << " samples" << std::endl;
+    std::cout << std::left << std::setw(24) << "Phase" << std::right
+        << std::setw(10) << "Calls"
+        << std::setw(16) << "Cycles"
+        << std::setw(16) << "Instructions"
+        << std::setw(8) << "IPC"
+        << std::setw(16) << "L1 miss/sample"
+        << std::setw(17) << "LLC miss/sample"
+        << std::setw(20) << "Branch miss/sample"
+        << "  Status" << std::endl;
+
+    for (size_t phase_index = 0; phase_index < profile_phase_count; phase_index++)
+    {
+        std::array<uint64_t, profile_counter_count> &total = this->totals[phase_index];
+        double ipc = total[Cycles] ? (double)total[Instructions] / total[Cycles] : 0;
+
+        std::cout << std::left << std::setw(24) << phase_names[phase_index] << std::right << std::fixed
+            << std::setw(10) << this->call_counts[phase_index]
+            << std::setw(16) << total[Cycles]
+            << std::setw(16) << total[Instructions]
+            << std::setw(8) << std::setprecision(2) << ipc
+            << std::setw(16) << total[L1Misses] / sample_count
+            << std::setw(17) << total[LLCMisses] / sample_count
+            << std::setw(20) << total[BranchMisses] / sample_count
+            << "  " << this->get_phase_status(phase_index) << std::endl;
+    }
+}
+
+void Profiler::export_csv(std::string file_path)
+{
+    if (!this->is_available())
+        return;
+
+    std::ofstream file;
+    file.open(file_path);
+
+    double sample_count = std::max<size_t>(this->sample_count, 1);
+
+    file << "phase,calls,samples,cycles,instructions,ipc,l1_misses_per_sample,llc_misses_per_sample,branch_misses_per_sample,status" << std::endl;
+
+    for (size_t phase_index = 0; phase_index < profile_phase_count; phase_index++)
+    {
+        std::array<uint64_t, profile_counter_count> &total = this->totals[phase_index];
+        double ipc = total[Cycles] ? (double)total[Instructions] / total[Cycles] : 0;
+
+        file << phase_names[phase_index] << ","
+            << this->call_counts[phase_index] << ","
+            << this->sample_count << ","
+            << total[Cycles] << ","
+            << total[Instructions] << ","
+            << ipc << ","
+            << total[L1Misses] / sample_count << ","
+            << total[LLCMisses] / sample_count << ","
+            << total[BranchMisses] / sample_count << ","
+            << this->get_phase_status(phase_index) << std::endl;
+    }
+    file.close();
+}
+
+std::array<uint64_t, profile_counter_count> Profiler::read_counters()
+{
+    std::array<uint64_t, profile_counter_count> values{};
+
+#ifdef __linux__
+    // The group read returns the number of counters, the time the group was
+    // enabled and the time it actually ran, then the values in the order the
+    // counters joined the group.
+    uint64_t buffer[profile_counter_count + 3] = {};
+
+    if (read(this->group_fd, buffer, sizeof(buffer)) <= 0)
+        return values;
+
+    uint64_t counter_count = buffer[0];
+    uint64_t time_enabled = buffer[1];
+    uint64_t time_running = buffer[2];
+
+    this->is_last_read_unscheduled = time_running == 0;
+    this->is_last_read_scaled = time_running > 0 && time_running < time_enabled;
+
+    double scale = this->is_last_read_scaled ? (double)time_enabled / time_running : 1;
+
+    size_t value_index = 3;
+    for (size_t counter_index = 0; counter_index < profile_counter_count && value_index < counter_count + 3; counter_index++)
+    {
+        if (this->counter_fds[counter_index] != -1)
+            values[counter_index] = (uint64_t)(buffer[value_index++] * scale);
+    }
+#endif
+
+    return values;
+}
+
+
+const char *Profiler::get_phase_status(size_t phase_index)
+{
+    if (this->unscheduled_phases[phase_index])
+        return "not_scheduled";
+    if (this->scaled_phases[phase_index])
+        return "scaled";
+
+    return "exact";
+}
\ No newline at end of file
@@ -0,0 +1,50 @@
+#pragma once
+#include <stddef.h>
+#include <array>
+#include <cstdint>
+#include <string>
+
+enum class ProfilePhase {
+    DataLoading,
+    CalculateNeurons,
+    UpdateLearningRules,
+    UpdateWeights
+};
+
+constexpr size_t profile_phase_count = 4;
+constexpr size_t profile_counter_count = 5;
+
+// Collects hardware performance counters (Linux perf_event_open) around each
+// profiled phase. Misses are reported per sample, where a sample is one
+// Perceptron::train() or run() call. When the kernel multiplexes the counter
+// group the counts are scaled by enabled/running time and the phase is marked
+// "scaled"; a group that never ran is marked "not_scheduled". When the counters
+// cannot be opened every call is a no-op.
+class Profiler{
+    public:
+        Profiler();
+        ~Profiler();
+        Profiler(const Profiler &) = delete;
+        Profiler &operator=(const Profiler &) = delete;
+        bool is_available();
+        void begin(ProfilePhase phase);
+        void end(ProfilePhase phase);
+        void add_sample();
+        void print();
+        void export_csv(std::string file_path);
+
+    private:
+        std::array<uint64_t, profile_counter_count> read_counters();
+        const char *get_phase_status(size_t phase_index);
+
+        int group_fd;
+        std::array<int, profile_counter_count> counter_fds;
+        std::array<std::array<uint64_t, profile_counter_count>, profile_phase_count> phase_starts;
+        std::array<std::array<uint64_t, profile_counter_count>, profile_phase_count> totals;
+        std::array<size_t, profile_phase_count> call_counts;
+        size_t sample_count;
+        bool is_last_read_scaled;
+        bool is_last_read_unscheduled;
+        std::array<bool, profile_phase_count> scaled_phases;
+        std::array<bool, profile_phase_count> unscheduled_phases;
+};
@@ -0,0 +1,75 @@
+#include "random.hpp"
+#include <cmath>
+
+constexpr uint32_t philox_multiplier_0 = 0xD2511F53;
+constexpr uint32_t philox_multiplier_1 = 0xCD9E8D57;
+constexpr uint32_t philox_weyl_0 = 0x9E3779B9;
+constexpr uint32_t philox_weyl_1 = 0xBB67AE85;
+constexpr size_t philox_round_count = 10;
+
+constexpr double uniform_limit = 0.1;
+
+Philox::Philox(uint64_t seed) : seed(seed){};
+
+std::array<uint32_t, 4> Philox::generate(uint64_t stream, uint64_t index) const
+{
+    std::array<uint32_t, 4> counter = {
+        (uint32_t)index,
+        (uint32_t)(index >> 32),
+        (uint32_t)stream,
+        (uint32_t)(stream >> 32)
+    };
+    uint32_t key_0 = (uint32_t)this->seed;
+    uint32_t key_1 = (uint32_t)(this->seed >> 32);
+
+    for (size_t round = 0; round < philox_round_count; round++)
+    {
+        uint64_t product_0 = (uint64_t)philox_multiplier_0 * counter[0];
+        uint64_t product_1 = (uint64_t)philox_multiplier_1 * counter[2];
+
+        counter = {
+            (uint32_t)(product_1 >> 32) ^ counter[1] ^ key_0,
+            (uint32_t)product_1,
+            (uint32_t)(product_0 >> 32) ^ counter[3] ^ key_1,
+            (uint32_t)product_0
+        };
+
+        key_0 += philox_weyl_0;
+        key_1 += philox_weyl_1;
+    }
+
+    return counter;
+}
+
+double Philox::uniform(uint64_t stream, uint64_t index) const
+{
+    std::array<uint32_t, 4> random = this->generate(stream, index);
+    uint64_t bits = ((uint64_t)random[0] << 21) | (random[1] >> 11);
+
+    return bits * 0x1.0p-53;
+}
+
+WeightInitializer::WeightInitializer(uint64_t seed, Initialization initialization, size_t layer_index, size_t input_count, size_t layer_size) :
+    generator(seed),
+    layer_index(layer_index),
+    input_count(input_count)
+{
+    switch (initialization)
+    {
+        case Initialization::Xavier:
+            this->limit = sqrt(6.0 / (input_count + layer_size));
+            break;
+        case Initialization::He:
+            this->limit = sqrt(6.0 / input_count);
+            break;
+        default:
+            this->limit = uniform_limit;
+    }
+}
+
+double WeightInitializer::get_weight(size_t neuron_index, size_t input_index) const
+{
+    double random = this->generator.uniform(this->layer_index, neuron_index * this->input_count + input_index);
+
+    return (random * 2 - 1) * this->limit;
+}
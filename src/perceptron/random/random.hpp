@@ -0,0 +1,34 @@
+#pragma once
+#include <stddef.h>
+#include <array>
+#include <cstdint>
+
+enum class Initialization {
+    Uniform,
+    Xavier,
+    He
+};
+
+// Counter-based Philox4x32-10 generator: every value is a pure function of
+// (seed, counter), so weights can be drawn in any order on any thread.
+class Philox{
+    public:
+        Philox(uint64_t seed);
+        std::array<uint32_t, 4> generate(uint64_t stream, uint64_t index) const;
+        double uniform(uint64_t stream, uint64_t index) const;
+
+    private:
+        uint64_t seed;
+};
+
+class WeightInitializer{
+    public:
+        WeightInitializer(uint64_t seed, Initialization initialization, size_t layer_index, size_t input_count, size_t layer_size);
+        double get_weight(size_t neuron_index, size_t input_index) const;
+
+    private:
+        Philox generator;
+        size_t layer_index;
+        size_t input_count;
+        double limit;
+};
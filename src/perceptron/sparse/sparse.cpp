@@ -0,0 +1,188 @@
+#include "sparse.hpp"
+#include "../neuron/neuron.hpp"
+#include "../dense/dense.hpp"
+
+SparseMatrix::SparseMatrix(std::vector<std::vector<double>> &rows, size_t column_count) :
+    row_count(rows.size()),
+    column_count(column_count)
+{
+    this->row_offsets.reserve(this->row_count + 1);
+    this->row_offsets.push_back(0);
+
+    for (std::vector<double> &row : rows)
+    {
+        for (size_t column_index = 0; column_index < row.size(); column_index++)
+        {
+            if (row[column_index] == 0)
+                continue;
+
+            this->values.push_back(row[column_index]);
+            this->column_indices.push_back(column_index);
+        }
+        this->row_offsets.push_back(this->values.size());
+    }
+}
+
+std::vector<double> SparseMatrix::multiply(const std::vector<double> &vector)
+{
+    std::vector<double> result(this->row_count);
+
+    for (size_t row_index = 0; row_index < this->row_count; row_index++)
+    {
+        double sum = 0;
+        for (size_t value_index = this->row_offsets[row_index]; value_index < this->row_offsets[row_index + 1]; value_index++)
+        {
+            sum += this->values[value_index] * vector[this->column_indices[value_index]];
+        }
+        result[row_index] = sum;
+    }
+
+    return result;
+}
+
+std::vector<std::vector<double>> SparseMatrix::multiply(const std::vector<std::vector<double>> &batch)
+{
+    std::vector<std::vector<double>> result(batch.size(), std::vector<double>(this->row_count));
+
+    // Walk every stored weight once per batch instead of once per sample, so the
+    // compressed rows stay in cache while the samples are accumulated.
+    for (size_t row_index = 0; row_index < this->row_count; row_index++)
+    {
+        for (size_t value_index = this->row_offsets[row_index]; value_index < this->row_offsets[row_index + 1]; value_index++)
+        {
+            double value = this->values[value_index];
+            uint32_t column_index = this->column_indices[value_index];
+
+            for (size_t sample_index = 0; sample_index < batch.size(); sample_index++)
+            {
+                result[sample_index][row_index] += value * batch[sample_index][column_index];
+            }
+        }
+    }
+
+    return result;
+}
+
+size_t SparseMatrix::get_row_count()
+{
+    return this->row_count;
+}
+
+size_t SparseMatrix::get_column_count()
+{
+    return this->column_count;
+}
+
+size_t SparseMatrix::get_nonzero_count()
+{
+    return this->values.size();
+}
+
+size_t SparseMatrix::get_memory_size()
+{
+    return this->values.size() * sizeof(double)
+        + this->column_indices.size() * sizeof(uint32_t)
+        + this->row_offsets.size() * sizeof(uint32_t);
+}
+
+SparsePerceptron::SparsePerceptron
+(
+    size_t input_size,
+    size_t output_size,
+    size_t layer_count,
+    size_t hidden_layer_size,
+    std::vector<std::vector<double>> &weights
+)
+{
+    for (WeightLayer &weight_layer : split_weight_layers(weights, input_size, output_size, layer_count, hidden_layer_size))
+    {
+        this->layers.emplace_back(weight_layer.rows, weight_layer.column_count);
+    }
+}
+
+std::vector<double> SparsePerceptron::run(const std::vector<double> &input)
+{
+    std::vector<double> values = input;
+    for (double &value : values)
+    {
+        value = Neuron::clamp(value);
+    }
+
+    for (SparseMatrix &layer : this->layers)
+    {
+        values = layer.multiply(values);
+        for (double &value : values)
+        {
+            value = Neuron::activation(value);
+        }
+    }
+
+    return values;
+}
+
+std::vector<std::vector<double>> SparsePerceptron::run(const std::vector<std::vector<double>> &batch)
+{
+    std::vector<std::vector<double>> values = batch;
+    for (std::vector<double> &sample : values)
+    {
+        for (double &value : sample)
+        {
+            value = Neuron::clamp(value);
+        }
+    }
+
+    for (SparseMatrix &layer : this->layers)
+    {
+        values = layer.multiply(values);
+        for (std::vector<double> &sample : values)
+        {
+            for (double &value : sample)
+            {
+                value = Neuron::activation(value);
+            }
+        }
+    }
+
+    return values;
+}
+
+double SparsePerceptron::get_sparsity()
+{
+    size_t weight_count = 0;
+    size_t nonzero_count = 0;
+
+    for (SparseMatrix &layer : this->layers)
+    {
+        weight_count += layer.get_row_count() * layer.get_column_count();
+        nonzero_count += layer.get_nonzero_count();
+    }
+
+    if (weight_count == 0)
+        return 0;
+
+    return 1 - (double)nonzero_count / (double)weight_count;
+}
+
+size_t SparsePerceptron::get_memory_size()
+{
+    size_t memory_size = 0;
+
+    for (SparseMatrix &layer : this->layers)
+    {
+        memory_size += layer.get_memory_size();
+    }
+
+    return memory_size;
+}
+
+size_t SparsePerceptron::get_dense_memory_size()
+{
+    size_t memory_size = 0;
+
+    for (SparseMatrix &layer : this->layers)
+    {
+        memory_size += layer.get_row_count() * layer.get_column_count() * sizeof(double);
+    }
+
+    return memory_size;
+}
@@ -0,0 +1,42 @@
+#pragma once
+#include <stddef.h>
+#include <vector>
+#include <cstdint>
+
+class SparseMatrix{
+    public:
+        SparseMatrix(std::vector<std::vector<double>> &rows, size_t column_count);
+        std::vector<double> multiply(const std::vector<double> &vector);
+        std::vector<std::vector<double>> multiply(const std::vector<std::vector<double>> &batch);
+        size_t get_row_count();
+        size_t get_column_count();
+        size_t get_nonzero_count();
+        size_t get_memory_size();
+
+    private:
+        size_t row_count;
+        size_t column_count;
+        std::vector<double> values;
+        std::vector<uint32_t> column_indices;
+        std::vector<uint32_t> row_offsets;
+};
+
+class SparsePerceptron{
+    public:
+        SparsePerceptron
+        (
+            size_t input_size,
+            size_t output_size,
+            size_t layer_count,
+            size_t hidden_layer_size,
+            std::vector<std::vector<double>> &weights
+        );
+        std::vector<double> run(const std::vector<double> &input);
+        std::vector<std::vector<double>> run(const std::vector<std::vector<double>> &batch);
+        double get_sparsity();
+        size_t get_memory_size();
+        size_t get_dense_memory_size();
+
+    private:
+        std::vector<SparseMatrix> layers;
+};